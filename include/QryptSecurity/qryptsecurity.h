@@ -1,14 +1,39 @@
 #ifndef QRYPTSECURITY_H
 #define QRYPTSECURITY_H
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "qryptsecurity_exceptions.h"
+
 namespace QryptSecurity {
 
 const std::string QRYPTSECURITY_VERSION = "0.5";
 
+/// <summary>
+/// Size (in bytes) of a SYMMETRIC_KEY_MODE_AES_256 key
+/// </summary>
+const size_t AES_256_KEY_SIZE = 32;
+
+/// <summary>
+/// Minimum size (in bytes) of a single SYMMETRIC_KEY_MODE_OTP key agreement
+/// </summary>
+const size_t OTP_AGREEMENT_SIZE_MIN = 16;
+
+/// <summary>
+/// Maximum size (in bytes) of a single SYMMETRIC_KEY_MODE_OTP key agreement
+/// </summary>
+const size_t OTP_AGREEMENT_SIZE_MAX = 32768;
+
 /// <summary>
 /// Structure to store random location configurations
 /// </summary>
@@ -104,6 +129,23 @@ struct SymmetricKeyData {
 
 };
 
+/// <summary>
+/// Structure to store a batch of symmetric keys sharing one metadata
+/// </summary>
+struct SymmetricKeyBatchData {
+
+    /// <summary>
+    /// Symmetric keys
+    /// </summary>
+    std::vector<std::vector<uint8_t>> keys;
+
+    /// <summary>
+    /// Symmetric key metadata for the whole batch, including the key count and key size
+    /// </summary>
+    std::vector<uint8_t> metadata;
+
+};
+
 /// <summary>
 /// Enumeration of asymmetric key modes
 /// </summary>
@@ -146,6 +188,74 @@ struct AsymmetricKeyPair {
 
 };
 
+/// <summary>
+/// Size (in bytes) of an ASYMMETRIC_KEY_MODE_ECDH (X25519) private key
+/// </summary>
+const size_t ECDH_PRIVATE_KEY_SIZE = 32;
+
+/// <summary>
+/// Size (in bytes) of an ASYMMETRIC_KEY_MODE_ECDH (X25519) public key
+/// </summary>
+const size_t ECDH_PUBLIC_KEY_SIZE = 32;
+
+/// <summary>
+/// Size (in bytes) of an ASYMMETRIC_KEY_MODE_FRODO (FrodoKEM-1344) private key
+/// </summary>
+const size_t FRODO_PRIVATE_KEY_SIZE = 43088;
+
+/// <summary>
+/// Size (in bytes) of an ASYMMETRIC_KEY_MODE_FRODO (FrodoKEM-1344) public key
+/// </summary>
+const size_t FRODO_PUBLIC_KEY_SIZE = 21520;
+
+/// <summary>
+/// Size (in bytes) of an ASYMMETRIC_KEY_MODE_KYBER (Kyber1024) private key
+/// </summary>
+const size_t KYBER_PRIVATE_KEY_SIZE = 3168;
+
+/// <summary>
+/// Size (in bytes) of an ASYMMETRIC_KEY_MODE_KYBER (Kyber1024) public key
+/// </summary>
+const size_t KYBER_PUBLIC_KEY_SIZE = 1568;
+
+/// <summary>
+/// Returns the private key size of an asymmetric key mode without generating a key
+/// </summary>
+///
+/// <param name="mode">Asymmetric key algorithm</param>
+/// <returns>Private key size</returns>
+inline size_t asymmetricPrivateKeySize(AsymmetricKeyMode mode) {
+    switch (mode) {
+        case AsymmetricKeyMode::ASYMMETRIC_KEY_MODE_ECDH:
+            return ECDH_PRIVATE_KEY_SIZE;
+        case AsymmetricKeyMode::ASYMMETRIC_KEY_MODE_FRODO:
+            return FRODO_PRIVATE_KEY_SIZE;
+        case AsymmetricKeyMode::ASYMMETRIC_KEY_MODE_KYBER:
+            return KYBER_PRIVATE_KEY_SIZE;
+        default:
+            throw InvalidArgument("Invalid asymmetric key mode");
+    }
+}
+
+/// <summary>
+/// Returns the public key size of an asymmetric key mode without generating a key
+/// </summary>
+///
+/// <param name="mode">Asymmetric key algorithm</param>
+/// <returns>Public key size</returns>
+inline size_t asymmetricPublicKeySize(AsymmetricKeyMode mode) {
+    switch (mode) {
+        case AsymmetricKeyMode::ASYMMETRIC_KEY_MODE_ECDH:
+            return ECDH_PUBLIC_KEY_SIZE;
+        case AsymmetricKeyMode::ASYMMETRIC_KEY_MODE_FRODO:
+            return FRODO_PUBLIC_KEY_SIZE;
+        case AsymmetricKeyMode::ASYMMETRIC_KEY_MODE_KYBER:
+            return KYBER_PUBLIC_KEY_SIZE;
+        default:
+            throw InvalidArgument("Invalid asymmetric key mode");
+    }
+}
+
 /// <summary>
 /// Enumeration of cache state
 /// </summary>
@@ -188,6 +298,26 @@ struct CacheStatus {
 
 };
 
+/// <summary>
+/// Completion callback for asynchronous calls returning SymmetricKeyData
+///
+/// On failure the data is empty and error holds the exception thrown by the call.
+/// </summary>
+typedef std::function<void(SymmetricKeyData data, std::exception_ptr error)> SymmetricKeyDataCallback;
+
+/// <summary>
+/// Completion callback for asynchronous calls returning a symmetric key
+///
+/// On failure the key is empty and error holds the exception thrown by the call.
+/// </summary>
+typedef std::function<void(std::vector<uint8_t> key, std::exception_ptr error)> SymmetricKeyCallback;
+
+/// <summary>
+/// Fixed-size thread pool for the asynchronous calls, defined in qryptsecurity_executor.h
+/// together with the asynchronous members of the clients
+/// </summary>
+class KeyGenExecutor;
+
 /// <summary>
 /// KeyGenDistributedClient
 ///
@@ -237,12 +367,123 @@ class IKeyGenDistributedClient {
 
     /// <summary>
     /// Generate symmetric key for this client from metadata
+    ///
+    /// The metadata is taken by value; pass it with std::move when it is no longer 
+    /// needed to avoid copying it.
     /// </summary>
     ///
     /// <param name="metadata">Symmetric key metadata</param>
     /// <returns>Symmetric key</returns>
     virtual std::vector<uint8_t> genSync(std::vector<uint8_t> metadata) = 0;
 
+    /// <summary>
+    /// Generate symmetric key for this client from metadata into a caller-owned buffer
+    ///
+    /// This is a secure-copy convenience: the key is still allocated by the library, then
+    /// copied into the caller's buffer and the library's copy is zeroized. It adds a copy
+    /// and does not make the call allocation-free.
+    /// </summary>
+    ///
+    /// <param name="metadata">Symmetric key metadata</param>
+    /// <param name="key">Buffer to receive the symmetric key</param>
+    /// <param name="keyCapacity">Size of the key buffer</param>
+    /// <returns>Number of key bytes written</returns>
+    size_t genSync(std::vector<uint8_t> metadata, uint8_t* key, size_t keyCapacity);
+
+    /// <summary>
+    /// Generate multiple symmetric keys for this client and one metadata for other client
+    ///
+    /// The batch is generated by ceil(count * keySize / OTP_AGREEMENT_SIZE_MAX) key
+    /// agreements of at most OTP_AGREEMENT_SIZE_MAX bytes each, e.g. one agreement per
+    /// 1024 AES-256 keys, so the BLAST server round trips are shared by the keys in each
+    /// agreement. count * keySize must be at least OTP_AGREEMENT_SIZE_MIN, and count and
+    /// keySize must each fit in 32 bits. The metadata records the key count and key size
+    /// and the other client rebuilds the keys with genSyncBatch. Arguments are in the same
+    /// order as IKeyGenLocalClient::genSymmetricKeys. The input argument keySize is ignored
+    /// for SYMMETRIC_KEY_MODE_AES_256 mode.
+    /// </summary>
+    ///
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="count">Number of keys to generate</param>
+    /// <param name="keySize">Symmetric key size when using OTP mode</param>
+    /// <returns>Symmetric keys and metadata</returns>
+    SymmetricKeyBatchData genInitBatch(const SymmetricKeyMode mode, const size_t count, const size_t keySize);
+
+    /// <summary>
+    /// Generate multiple symmetric keys for this client from metadata created by
+    /// genInitBatch(mode, count, keySize)
+    ///
+    /// Throws DataCorrupted if the metadata is not valid batch metadata.
+    /// </summary>
+    ///
+    /// <param name="metadata">Symmetric key metadata for the whole batch</param>
+    /// <returns>Symmetric keys</returns>
+    std::vector<std::vector<uint8_t>> genSyncBatch(std::vector<uint8_t> metadata);
+
+    /// <summary>
+    /// Asynchronously generate symmetric key for this client and metadata for other client
+    ///
+    /// The call runs on executor. The returned future does not block on destruction;
+    /// a dropped call still runs to completion on executor. The client must outlive the call.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to run the call on</param>
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <returns>Future holding the symmetric key and metadata</returns>
+    std::future<SymmetricKeyData> genInitAsync(KeyGenExecutor& executor, const SymmetricKeyMode mode);
+
+    /// <summary>
+    /// Asynchronously generate symmetric key for this client and metadata for other client
+    ///
+    /// The call runs on executor. The returned future does not block on destruction;
+    /// a dropped call still runs to completion on executor. The client must outlive the call.
+    /// The input argument keySize is ignored for SYMMETRIC_KEY_MODE_AES_256 mode.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to run the call on</param>
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="keySize">Symmetric key size when using OTP mode</param>
+    /// <returns>Future holding the symmetric key and metadata</returns>
+    std::future<SymmetricKeyData> genInitAsync(KeyGenExecutor& executor, const SymmetricKeyMode mode, const size_t keySize);
+
+    /// <summary>
+    /// Asynchronously generate symmetric key for this client and metadata for other client
+    ///
+    /// The call runs on executor and callback is invoked on the executor thread when it
+    /// completes. The client must outlive the call.
+    /// The input argument keySize is ignored for SYMMETRIC_KEY_MODE_AES_256 mode.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to run the call on</param>
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="keySize">Symmetric key size when using OTP mode</param>
+    /// <param name="callback">Callback receiving the symmetric key and metadata</param>
+    void genInitAsync(KeyGenExecutor& executor, const SymmetricKeyMode mode, const size_t keySize, SymmetricKeyDataCallback callback);
+
+    /// <summary>
+    /// Asynchronously generate symmetric key for this client from metadata
+    ///
+    /// The call runs on executor. The returned future does not block on destruction;
+    /// a dropped call still runs to completion on executor. The client must outlive the call.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to run the call on</param>
+    /// <param name="metadata">Symmetric key metadata</param>
+    /// <returns>Future holding the symmetric key</returns>
+    std::future<std::vector<uint8_t>> genSyncAsync(KeyGenExecutor& executor, std::vector<uint8_t> metadata);
+
+    /// <summary>
+    /// Asynchronously generate symmetric key for this client from metadata
+    ///
+    /// The call runs on executor and callback is invoked on the executor thread when it
+    /// completes. The client must outlive the call.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to run the call on</param>
+    /// <param name="metadata">Symmetric key metadata</param>
+    /// <param name="callback">Callback receiving the symmetric key</param>
+    void genSyncAsync(KeyGenExecutor& executor, std::vector<uint8_t> metadata, SymmetricKeyCallback callback);
+
 };
 
 /// <summary>
@@ -309,6 +550,41 @@ class IKeyGenLocalClient {
     /// <returns>Asymmetric key</returns>
     virtual AsymmetricKeyPair genAsymmetricKeys(AsymmetricKeyMode mode) = 0;
 
+    /// <summary>
+    /// Generate asymmetric keys into caller-owned buffers
+    ///
+    /// On input privateKeySize and publicKeySize hold the capacity of the buffers,
+    /// on output they hold the number of bytes written. Size the buffers with
+    /// asymmetricPrivateKeySize and asymmetricPublicKeySize. If either buffer is too small,
+    /// both are set to the required sizes and InvalidArgument is thrown before any key
+    /// is generated.
+    ///
+    /// This is a secure-copy convenience: the keys are still allocated by the library, then
+    /// copied into the caller's buffers and the library's copies are zeroized. It adds a copy
+    /// and does not make the call allocation-free.
+    /// </summary>
+    ///
+    /// <param name="mode">Asymmetric key algorithm</param>
+    /// <param name="privateKey">Buffer to receive the private key</param>
+    /// <param name="privateKeySize">Capacity of, then bytes written to, privateKey</param>
+    /// <param name="publicKey">Buffer to receive the public key</param>
+    /// <param name="publicKeySize">Capacity of, then bytes written to, publicKey</param>
+    void genAsymmetricKeys(AsymmetricKeyMode mode, uint8_t* privateKey, size_t& privateKeySize, uint8_t* publicKey, size_t& publicKeySize);
+
+    /// <summary>
+    /// Generate multiple asymmetric keys
+    ///
+    /// Key pairs are generated concurrently on executor, so the number of threads is
+    /// bounded by the executor however many callers there are. Blocks until all key pairs
+    /// are generated; must not be called from a task running on the same executor.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to generate the key pairs on</param>
+    /// <param name="mode">Asymmetric key algorithm</param>
+    /// <param name="count">Number of key pairs to generate</param>
+    /// <returns>Asymmetric keys</returns>
+    std::vector<AsymmetricKeyPair> genAsymmetricKeys(KeyGenExecutor& executor, AsymmetricKeyMode mode, size_t count);
+
     /// <summary>
     /// Generate symmetric keys
     /// </summary>
@@ -328,8 +604,344 @@ class IKeyGenLocalClient {
     /// <returns>Symmetric key</returns>
     virtual std::vector<uint8_t> genSymmetricKey(SymmetricKeyMode mode, size_t keySize) = 0;
 
+    /// <summary>
+    /// Generate symmetric keys into a caller-owned buffer
+    ///
+    /// For SYMMETRIC_KEY_MODE_AES_256 mode keySize must be AES_256_KEY_SIZE.
+    ///
+    /// This is a secure-copy convenience: the key is still allocated by the library, then
+    /// copied into the caller's buffer and the library's copy is zeroized. It adds a copy
+    /// and does not make the call allocation-free.
+    /// </summary>
+    ///
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="key">Buffer to receive the symmetric key</param>
+    /// <param name="keySize">Size of the key buffer</param>
+    void genSymmetricKey(SymmetricKeyMode mode, uint8_t* key, size_t keySize);
+
+    /// <summary>
+    /// Asynchronously generate symmetric keys
+    ///
+    /// The call runs on executor. The returned future does not block on destruction;
+    /// a dropped call still runs to completion on executor. The client must outlive the call.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to run the call on</param>
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <returns>Future holding the symmetric key</returns>
+    std::future<std::vector<uint8_t>> genSymmetricKeyAsync(KeyGenExecutor& executor, SymmetricKeyMode mode);
+
+    /// <summary>
+    /// Asynchronously generate symmetric keys
+    ///
+    /// The call runs on executor. The returned future does not block on destruction;
+    /// a dropped call still runs to completion on executor. The client must outlive the call.
+    /// The input argument keySize is ignored for SYMMETRIC_KEY_MODE_AES_256 mode.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to run the call on</param>
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="keySize">Symmetric key size when using OTP mode</param>
+    /// <returns>Future holding the symmetric key</returns>
+    std::future<std::vector<uint8_t>> genSymmetricKeyAsync(KeyGenExecutor& executor, SymmetricKeyMode mode, size_t keySize);
+
+    /// <summary>
+    /// Asynchronously generate symmetric keys
+    ///
+    /// The call runs on executor and callback is invoked on the executor thread when it
+    /// completes. The client must outlive the call.
+    /// The input argument keySize is ignored for SYMMETRIC_KEY_MODE_AES_256 mode.
+    /// </summary>
+    ///
+    /// <param name="executor">Executor to run the call on</param>
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="keySize">Symmetric key size when using OTP mode</param>
+    /// <param name="callback">Callback receiving the symmetric key</param>
+    void genSymmetricKeyAsync(KeyGenExecutor& executor, SymmetricKeyMode mode, size_t keySize, SymmetricKeyCallback callback);
+
+    /// <summary>
+    /// Generate multiple symmetric keys
+    ///
+    /// The random for all keys is requested from the cache in a single call rather
+    /// than one call per key.
+    /// </summary>
+    ///
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="count">Number of keys to generate</param>
+    /// <returns>Symmetric keys</returns>
+    std::vector<std::vector<uint8_t>> genSymmetricKeys(SymmetricKeyMode mode, size_t count);
+
+    /// <summary>
+    /// Generate multiple symmetric keys
+    ///
+    /// The random for all keys is requested from the cache in a single call rather
+    /// than one call per key. The input argument keySize is ignored for 
+    /// SYMMETRIC_KEY_MODE_AES_256 mode.
+    /// </summary>
+    ///
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="count">Number of keys to generate</param>
+    /// <param name="keySize">Symmetric key size when using OTP mode</param>
+    /// <returns>Symmetric keys</returns>
+    std::vector<std::vector<uint8_t>> genSymmetricKeys(SymmetricKeyMode mode, size_t count, size_t keySize);
+
 };
 
+namespace detail {
+
+/// <summary>
+/// Overwrites a buffer with zeros in a way the compiler will not optimize away
+/// </summary>
+inline void secureZero(void* buffer, size_t size) {
+    volatile uint8_t* p = static_cast<volatile uint8_t*>(buffer);
+    while (size--) {
+        *p++ = 0;
+    }
+}
+
+/// <summary>
+/// Returns the key size to use for the given symmetric key mode
+/// </summary>
+inline size_t symmetricKeySize(SymmetricKeyMode mode, size_t keySize) {
+    switch (mode) {
+        case SymmetricKeyMode::SYMMETRIC_KEY_MODE_AES_256:
+            return AES_256_KEY_SIZE;
+        case SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP:
+            if (keySize == 0) {
+                throw InvalidArgument("keySize must be greater than 0");
+            }
+            return keySize;
+        default:
+            throw InvalidArgument("Invalid symmetric key mode");
+    }
+}
+
+/// <summary>
+/// Copies a key into a caller-owned buffer and zeroizes the source
+/// </summary>
+inline size_t moveKey(std::vector<uint8_t>& source, uint8_t* destination, size_t capacity) {
+    const size_t size = source.size();
+    if (size > capacity) {
+        secureZero(source.data(), size);
+        throw InvalidArgument("Output buffer is too small");
+    }
+    std::copy(source.begin(), source.end(), destination);
+    secureZero(source.data(), size);
+    return size;
+}
+
+/// <summary>
+/// Splits a contiguous random buffer into count keys of keySize bytes and zeroizes the buffer
+/// </summary>
+inline std::vector<std::vector<uint8_t>> splitKeys(std::vector<uint8_t>& random, size_t count, size_t keySize) {
+    if (random.size() != count * keySize) {
+        secureZero(random.data(), random.size());
+        throw UnknownError("Unexpected random size");
+    }
+
+    std::vector<std::vector<uint8_t>> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* begin = random.data() + i * keySize;
+        keys.emplace_back(begin, begin + keySize);
+    }
+    secureZero(random.data(), random.size());
+    return keys;
+}
+
+/// <summary>
+/// Version of the batch metadata layout
+///
+/// Layout (integers little-endian): uint8 version, uint32 key count, uint32 key size,
+/// uint32 agreement count, then per agreement a uint32 length and the agreement metadata.
+/// </summary>
+const uint8_t BATCH_METADATA_VERSION = 1;
+
+inline void appendUint32(std::vector<uint8_t>& buffer, size_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        buffer.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+inline size_t readUint32(const std::vector<uint8_t>& buffer, size_t& offset) {
+    if (buffer.size() - offset < 4) {
+        throw DataCorrupted("Invalid batch metadata");
+    }
+    size_t value = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        value |= static_cast<size_t>(buffer[offset++]) << shift;
+    }
+    return value;
+}
+
+} // namespace detail
+
+inline size_t IKeyGenDistributedClient::genSync(std::vector<uint8_t> metadata, uint8_t* key, size_t keyCapacity) {
+    if (key == nullptr) {
+        throw InvalidArgument("key must not be null");
+    }
+    std::vector<uint8_t> result = genSync(std::move(metadata));
+    return detail::moveKey(result, key, keyCapacity);
+}
+
+inline SymmetricKeyBatchData IKeyGenDistributedClient::genInitBatch(const SymmetricKeyMode mode, const size_t count, const size_t keySize) {
+    const size_t size = detail::symmetricKeySize(mode, keySize);
+    const size_t maxUint32 = 0xFFFFFFFF;
+    if (count == 0) {
+        throw InvalidArgument("count must be greater than 0");
+    }
+    if (count > maxUint32 || size > maxUint32 || count > std::numeric_limits<size_t>::max() / size) {
+        throw InvalidArgument("count * keySize is too large");
+    }
+    const size_t total = count * size;
+    if (total < OTP_AGREEMENT_SIZE_MIN) {
+        throw InvalidArgument("count * keySize must be at least 16 bytes");
+    }
+
+    // Keys are uniformly random bytes in both modes, so the batch is generated as OTP
+    // agreements of near-equal size, each within the limits of the distributed client
+    const size_t numAgreements = (total + OTP_AGREEMENT_SIZE_MAX - 1) / OTP_AGREEMENT_SIZE_MAX;
+    if (numAgreements > maxUint32) {
+        throw InvalidArgument("count * keySize is too large");
+    }
+
+    SymmetricKeyBatchData batch;
+    batch.metadata.push_back(detail::BATCH_METADATA_VERSION);
+    detail::appendUint32(batch.metadata, count);
+    detail::appendUint32(batch.metadata, size);
+    detail::appendUint32(batch.metadata, numAgreements);
+
+    std::vector<uint8_t> random;
+    random.reserve(total);
+    try {
+        for (size_t i = 0; i < numAgreements; i++) {
+            const size_t agreementSize = total / numAgreements + (i < total % numAgreements ? 1 : 0);
+            SymmetricKeyData data = genInit(SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP, agreementSize);
+            random.insert(random.end(), data.key.begin(), data.key.end());
+            detail::secureZero(data.key.data(), data.key.size());
+            detail::appendUint32(batch.metadata, data.metadata.size());
+            batch.metadata.insert(batch.metadata.end(), data.metadata.begin(), data.metadata.end());
+        }
+    } catch (...) {
+        detail::secureZero(random.data(), random.size());
+        throw;
+    }
+
+    batch.keys = detail::splitKeys(random, count, size);
+    return batch;
+}
+
+inline std::vector<std::vector<uint8_t>> IKeyGenDistributedClient::genSyncBatch(std::vector<uint8_t> metadata) {
+    if (metadata.empty() || metadata[0] != detail::BATCH_METADATA_VERSION) {
+        throw DataCorrupted("Invalid batch metadata");
+    }
+    size_t offset = 1;
+    const size_t count = detail::readUint32(metadata, offset);
+    const size_t size = detail::readUint32(metadata, offset);
+    const size_t numAgreements = detail::readUint32(metadata, offset);
+    if (count == 0 || size == 0 || count > std::numeric_limits<size_t>::max() / size) {
+        throw DataCorrupted("Invalid batch metadata");
+    }
+    const size_t total = count * size;
+    if (total < OTP_AGREEMENT_SIZE_MIN || numAgreements != (total + OTP_AGREEMENT_SIZE_MAX - 1) / OTP_AGREEMENT_SIZE_MAX) {
+        throw DataCorrupted("Invalid batch metadata");
+    }
+
+    // Check the layout of every agreement before allocating or making any calls
+    const size_t agreementsOffset = offset;
+    for (size_t i = 0; i < numAgreements; i++) {
+        const size_t length = detail::readUint32(metadata, offset);
+        if (metadata.size() - offset < length) {
+            throw DataCorrupted("Invalid batch metadata");
+        }
+        offset += length;
+    }
+    if (offset != metadata.size()) {
+        throw DataCorrupted("Invalid batch metadata");
+    }
+
+    std::vector<uint8_t> random;
+    random.reserve(total);
+    offset = agreementsOffset;
+    try {
+        for (size_t i = 0; i < numAgreements; i++) {
+            const size_t length = detail::readUint32(metadata, offset);
+            const std::vector<uint8_t>::const_iterator begin = metadata.begin() + static_cast<std::ptrdiff_t>(offset);
+            std::vector<uint8_t> key = genSync(std::vector<uint8_t>(begin, begin + static_cast<std::ptrdiff_t>(length)));
+            offset += length;
+            const size_t agreementSize = total / numAgreements + (i < total % numAgreements ? 1 : 0);
+            if (key.size() != agreementSize) {
+                detail::secureZero(key.data(), key.size());
+                throw DataCorrupted("Batch metadata does not match its key count and key size");
+            }
+            random.insert(random.end(), key.begin(), key.end());
+            detail::secureZero(key.data(), key.size());
+        }
+    } catch (...) {
+        detail::secureZero(random.data(), random.size());
+        throw;
+    }
+
+    return detail::splitKeys(random, count, size);
+}
+
+inline void IKeyGenLocalClient::genAsymmetricKeys(AsymmetricKeyMode mode, uint8_t* privateKey, size_t& privateKeySize, uint8_t* publicKey, size_t& publicKeySize) {
+    if (privateKey == nullptr || publicKey == nullptr) {
+        throw InvalidArgument("Key buffers must not be null");
+    }
+    const size_t requiredPrivateKeySize = asymmetricPrivateKeySize(mode);
+    const size_t requiredPublicKeySize = asymmetricPublicKeySize(mode);
+    if (requiredPrivateKeySize > privateKeySize || requiredPublicKeySize > publicKeySize) {
+        privateKeySize = requiredPrivateKeySize;
+        publicKeySize = requiredPublicKeySize;
+        throw InvalidArgument("Output buffer is too small");
+    }
+
+    AsymmetricKeyPair keyPair = genAsymmetricKeys(mode);
+    if (keyPair.privateKey.size() != requiredPrivateKeySize || keyPair.publicKey.size() != requiredPublicKeySize) {
+        detail::secureZero(keyPair.privateKey.data(), keyPair.privateKey.size());
+        throw UnknownError("Unexpected key size");
+    }
+    privateKeySize = detail::moveKey(keyPair.privateKey, privateKey, privateKeySize);
+    publicKeySize = detail::moveKey(keyPair.publicKey, publicKey, publicKeySize);
+}
+
+inline void IKeyGenLocalClient::genSymmetricKey(SymmetricKeyMode mode, uint8_t* key, size_t keySize) {
+    if (key == nullptr) {
+        throw InvalidArgument("key must not be null");
+    }
+    if (mode == SymmetricKeyMode::SYMMETRIC_KEY_MODE_AES_256 && keySize != AES_256_KEY_SIZE) {
+        throw InvalidArgument("keySize must be AES_256_KEY_SIZE for SYMMETRIC_KEY_MODE_AES_256");
+    }
+    keySize = detail::symmetricKeySize(mode, keySize);
+
+    std::vector<uint8_t> result = genSymmetricKey(mode, keySize);
+    if (result.size() != keySize) {
+        detail::secureZero(result.data(), result.size());
+        throw UnknownError("Unexpected key size");
+    }
+    detail::moveKey(result, key, keySize);
+}
+
+inline std::vector<std::vector<uint8_t>> IKeyGenLocalClient::genSymmetricKeys(SymmetricKeyMode mode, size_t count) {
+    return genSymmetricKeys(mode, count, 0);
+}
+
+inline std::vector<std::vector<uint8_t>> IKeyGenLocalClient::genSymmetricKeys(SymmetricKeyMode mode, size_t count, size_t keySize) {
+    keySize = detail::symmetricKeySize(mode, keySize);
+    if (count == 0) {
+        return {};
+    }
+    if (count > std::numeric_limits<size_t>::max() / keySize) {
+        throw InvalidArgument("count * keySize is too large");
+    }
+
+    // Keys are uniformly random bytes in both modes, so a single OTP request
+    // covers the whole batch
+    std::vector<uint8_t> random = genSymmetricKey(SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP, count * keySize);
+    return detail::splitKeys(random, count, keySize);
+}
+
 } // namespace
 
 #endif
@@ -0,0 +1,124 @@
+#ifndef QRYPTSECURITY_ASYNC_LOGGING_H
+#define QRYPTSECURITY_ASYNC_LOGGING_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "qryptsecurity_logging.h"
+
+namespace QryptSecurity
+{
+namespace logging
+{
+    #define MAX_QUEUED_MESSAGES_DEFAULT 65536
+
+    ///<summary>
+    /// ILogWriter that queues messages and forwards them to another ILogWriter on a
+    /// background thread, so the logging thread never formats or writes the log file.
+    ///
+    /// Install with setLogWriter(std::make_shared<AsyncLogWriter>(getLogWriter())).
+    /// Messages are dropped while the queue is full; the queue is flushed on destruction.
+    /// Registered ILogMessageReceiver callbacks are invoked on the background thread.
+    /// Messages below the level set through setLogLevel are discarded before queueing;
+    /// until setLogLevel is called every message is queued and the wrapped writer filters.
+    ///</summary>
+    class AsyncLogWriter : public ILogWriter {
+    private:
+        std::shared_ptr<ILogWriter> _LogWriter;
+        size_t _MaxQueuedMessages;
+        std::atomic<int> _LogLevel;
+        std::deque<std::pair<std::string, LogLevel>> _Queue;
+        std::condition_variable _Condition;
+        size_t _DroppedMessages = 0;
+        bool _Stop = false;
+        std::thread _Thread;
+
+        void _writeWorker() {
+            std::deque<std::pair<std::string, LogLevel>> batch;
+            std::unique_lock<std::mutex> lock(_Mutex);
+            while (true) {
+                _Condition.wait(lock, [this]() { return _Stop || !_Queue.empty(); });
+                if (_Queue.empty()) {
+                    return;
+                }
+                batch.swap(_Queue);
+                lock.unlock();
+                for (auto& entry : batch) {
+                    _LogWriter->logMessage(entry.first, entry.second);
+                }
+                batch.clear();
+                lock.lock();
+            }
+        }
+
+    public:
+        /// <summary>
+        /// Constructs AsyncLogWriter and starts the background writer thread.
+        /// </summary>
+        /// <param name="logWriter">The ILogWriter to forward messages to.</param>
+        /// <param name="maxQueuedMessages">Number of queued messages beyond which new messages are dropped.</param>
+        AsyncLogWriter(std::shared_ptr<ILogWriter> logWriter, size_t maxQueuedMessages = MAX_QUEUED_MESSAGES_DEFAULT)
+            : _LogWriter(std::move(logWriter)), _MaxQueuedMessages(maxQueuedMessages),
+              _LogLevel(static_cast<int>(LogLevel::QRYPTLIB_LOG_LEVEL_TRACE)) {
+            _Thread = std::thread(&AsyncLogWriter::_writeWorker, this);
+        }
+
+        /// <summary>
+        /// Writes all queued messages and stops the background writer thread.
+        /// </summary>
+        ~AsyncLogWriter() {
+            {
+                std::lock_guard<std::mutex> lock(_Mutex);
+                _Stop = true;
+            }
+            _Condition.notify_one();
+            _Thread.join();
+        }
+
+        /// <summary>
+        /// Returns the number of messages dropped because the queue was full.
+        /// </summary>
+        size_t getDroppedMessages() {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            return _DroppedMessages;
+        }
+
+        void logMessage(const std::string& message, LogLevel logLevel) override {
+            if (static_cast<int>(logLevel) < _LogLevel.load(std::memory_order_relaxed)) {
+                return;
+            }
+            {
+                std::lock_guard<std::mutex> lock(_Mutex);
+                if (_Queue.size() >= _MaxQueuedMessages) {
+                    _DroppedMessages++;
+                    return;
+                }
+                _Queue.emplace_back(message, logLevel);
+            }
+            _Condition.notify_one();
+        }
+
+        void registerCallback(ILogMessageReceiver *receiver) override { _LogWriter->registerCallback(receiver); }
+
+        void unregisterCallback() override { _LogWriter->unregisterCallback(); }
+
+        void enableFileLogging(std::string filePath = "qryptlib.log", uint32_t maxFileSizeInBytes = MAX_FILE_SIZE_DEFAULT) override {
+            _LogWriter->enableFileLogging(filePath, maxFileSizeInBytes);
+        }
+
+        void disableFileLogging() override { _LogWriter->disableFileLogging(); }
+
+        void setLogLevel(LogLevel logLevel) override {
+            _LogLevel.store(static_cast<int>(logLevel), std::memory_order_relaxed);
+            _LogWriter->setLogLevel(logLevel);
+        }
+    };
+
+}
+}
+#endif
@@ -0,0 +1,238 @@
+#ifndef QRYPTSECURITY_EXECUTOR_H
+#define QRYPTSECURITY_EXECUTOR_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "qryptsecurity.h"
+
+namespace QryptSecurity {
+
+/// <summary>
+/// KeyGenExecutor
+///
+/// Fixed-size pool of worker threads that runs asynchronous key generation calls.
+///
+/// Use cases:
+/// - Keep many key generation calls in flight with a bounded number of threads
+///
+/// Notes:
+/// - The number of threads is fixed at construction; further calls wait in a queue
+/// - Share one executor between clients to bound the total thread count
+/// - Queued calls are run to completion before the destructor returns
+/// - Exceptions escaping a submitted task, including from completion callbacks, are discarded
+/// </summary>
+class KeyGenExecutor {
+  private:
+    std::mutex _Mutex;
+    std::condition_variable _Condition;
+    std::deque<std::function<void()>> _Tasks;
+    bool _Stop = false;
+    std::vector<std::thread> _Workers;
+
+    void _runWorker() {
+        std::unique_lock<std::mutex> lock(_Mutex);
+        while (true) {
+            _Condition.wait(lock, [this]() { return _Stop || !_Tasks.empty(); });
+            if (_Tasks.empty()) {
+                return;
+            }
+            std::function<void()> task = std::move(_Tasks.front());
+            _Tasks.pop_front();
+            lock.unlock();
+            try {
+                task();
+            } catch (...) {
+            }
+            lock.lock();
+        }
+    }
+
+    void _stop() {
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _Stop = true;
+        }
+        _Condition.notify_all();
+        for (auto& worker : _Workers) {
+            worker.join();
+        }
+    }
+
+  public:
+
+    /// <summary>
+    /// Constructs KeyGenExecutor and starts its worker threads
+    /// </summary>
+    ///
+    /// <param name="numThreads">Number of worker threads. Defaults to the number of hardware threads.</param>
+    KeyGenExecutor(size_t numThreads = 0) {
+        if (numThreads == 0) {
+            numThreads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        try {
+            for (size_t i = 0; i < numThreads; i++) {
+                _Workers.emplace_back(&KeyGenExecutor::_runWorker, this);
+            }
+        } catch (...) {
+            _stop();
+            throw;
+        }
+    }
+
+    /// <summary>
+    /// Runs all queued calls and stops the worker threads
+    /// </summary>
+    ~KeyGenExecutor() {
+        _stop();
+    }
+
+    KeyGenExecutor(const KeyGenExecutor&) = delete;
+    KeyGenExecutor& operator=(const KeyGenExecutor&) = delete;
+
+    /// <summary>
+    /// Queues a task to run on one of the worker threads
+    /// </summary>
+    ///
+    /// <param name="task">The task to run</param>
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _Tasks.push_back(std::move(task));
+        }
+        _Condition.notify_one();
+    }
+};
+
+namespace detail {
+
+/// <summary>
+/// Runs call on executor and returns a future for its result
+/// </summary>
+template <typename Result>
+std::future<Result> submitFuture(KeyGenExecutor& executor, std::function<Result()> call) {
+    std::shared_ptr<std::promise<Result>> promise = std::make_shared<std::promise<Result>>();
+    std::future<Result> future = promise->get_future();
+    executor.submit([promise, call]() {
+        try {
+            promise->set_value(call());
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+/// <summary>
+/// Runs call on executor and passes its result or exception to callback
+/// </summary>
+template <typename Result>
+void submitCallback(KeyGenExecutor& executor, std::function<Result()> call, std::function<void(Result, std::exception_ptr)> callback) {
+    executor.submit([call, callback]() {
+        Result result;
+        std::exception_ptr error;
+        try {
+            result = call();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        callback(std::move(result), error);
+    });
+}
+
+} // namespace detail
+
+inline std::future<SymmetricKeyData> IKeyGenDistributedClient::genInitAsync(KeyGenExecutor& executor, const SymmetricKeyMode mode) {
+    return detail::submitFuture<SymmetricKeyData>(executor, [this, mode]() { return genInit(mode); });
+}
+
+inline std::future<SymmetricKeyData> IKeyGenDistributedClient::genInitAsync(KeyGenExecutor& executor, const SymmetricKeyMode mode, const size_t keySize) {
+    return detail::submitFuture<SymmetricKeyData>(executor, [this, mode, keySize]() {
+        const size_t size = detail::symmetricKeySize(mode, keySize);
+        return mode == SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP ? genInit(mode, size) : genInit(mode);
+    });
+}
+
+inline void IKeyGenDistributedClient::genInitAsync(KeyGenExecutor& executor, const SymmetricKeyMode mode, const size_t keySize, SymmetricKeyDataCallback callback) {
+    detail::submitCallback<SymmetricKeyData>(executor, [this, mode, keySize]() {
+        const size_t size = detail::symmetricKeySize(mode, keySize);
+        return mode == SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP ? genInit(mode, size) : genInit(mode);
+    }, std::move(callback));
+}
+
+inline std::future<std::vector<uint8_t>> IKeyGenDistributedClient::genSyncAsync(KeyGenExecutor& executor, std::vector<uint8_t> metadata) {
+    // Hold the metadata in a shared_ptr so it is moved, not copied, into the copyable task
+    std::shared_ptr<std::vector<uint8_t>> pendingMetadata = std::make_shared<std::vector<uint8_t>>(std::move(metadata));
+    return detail::submitFuture<std::vector<uint8_t>>(executor, [this, pendingMetadata]() { return genSync(std::move(*pendingMetadata)); });
+}
+
+inline void IKeyGenDistributedClient::genSyncAsync(KeyGenExecutor& executor, std::vector<uint8_t> metadata, SymmetricKeyCallback callback) {
+    std::shared_ptr<std::vector<uint8_t>> pendingMetadata = std::make_shared<std::vector<uint8_t>>(std::move(metadata));
+    detail::submitCallback<std::vector<uint8_t>>(executor, [this, pendingMetadata]() { return genSync(std::move(*pendingMetadata)); }, std::move(callback));
+}
+
+inline std::future<std::vector<uint8_t>> IKeyGenLocalClient::genSymmetricKeyAsync(KeyGenExecutor& executor, SymmetricKeyMode mode) {
+    return detail::submitFuture<std::vector<uint8_t>>(executor, [this, mode]() { return genSymmetricKey(mode); });
+}
+
+inline std::future<std::vector<uint8_t>> IKeyGenLocalClient::genSymmetricKeyAsync(KeyGenExecutor& executor, SymmetricKeyMode mode, size_t keySize) {
+    return detail::submitFuture<std::vector<uint8_t>>(executor, [this, mode, keySize]() {
+        const size_t size = detail::symmetricKeySize(mode, keySize);
+        return mode == SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP ? genSymmetricKey(mode, size) : genSymmetricKey(mode);
+    });
+}
+
+inline void IKeyGenLocalClient::genSymmetricKeyAsync(KeyGenExecutor& executor, SymmetricKeyMode mode, size_t keySize, SymmetricKeyCallback callback) {
+    detail::submitCallback<std::vector<uint8_t>>(executor, [this, mode, keySize]() {
+        const size_t size = detail::symmetricKeySize(mode, keySize);
+        return mode == SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP ? genSymmetricKey(mode, size) : genSymmetricKey(mode);
+    }, std::move(callback));
+}
+
+inline std::vector<AsymmetricKeyPair> IKeyGenLocalClient::genAsymmetricKeys(KeyGenExecutor& executor, AsymmetricKeyMode mode, size_t count) {
+    std::vector<std::future<AsymmetricKeyPair>> pending;
+    std::vector<AsymmetricKeyPair> keyPairs;
+    std::exception_ptr error;
+    try {
+        pending.reserve(count);
+        keyPairs.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            pending.push_back(detail::submitFuture<AsymmetricKeyPair>(executor, [this, mode]() { return genAsymmetricKeys(mode); }));
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // Wait for every submitted call, even after a failure, so none outlives this call
+    // and every generated private key can be zeroized
+    for (auto& future : pending) {
+        try {
+            keyPairs.push_back(future.get());
+        } catch (...) {
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error) {
+        for (auto& keyPair : keyPairs) {
+            detail::secureZero(keyPair.privateKey.data(), keyPair.privateKey.size());
+        }
+        std::rethrow_exception(error);
+    }
+    return keyPairs;
+}
+
+} // namespace
+
+#endif
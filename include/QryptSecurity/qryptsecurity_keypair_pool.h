@@ -0,0 +1,164 @@
+#ifndef QRYPTSECURITY_KEYPAIR_POOL_H
+#define QRYPTSECURITY_KEYPAIR_POOL_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "qryptsecurity.h"
+#include "qryptsecurity_logging.h"
+
+namespace QryptSecurity {
+
+/// <summary>
+/// Default number of pre-generated key pairs held by a KeyPairPool
+/// </summary>
+const size_t KEYPAIR_POOL_SIZE_DEFAULT = 16;
+
+/// <summary>
+/// Time (in milliseconds) a KeyPairPool worker waits after a failed generation
+/// </summary>
+const size_t KEYPAIR_POOL_RETRY_INTERVAL = 1000;
+
+/// <summary>
+/// KeyPairPool
+///
+/// Pre-generates asymmetric key pairs of one AsymmetricKeyMode on background worker
+/// threads and hands them out on demand.
+///
+/// Use cases:
+/// - Take expensive key generation (e.g. ASYMMETRIC_KEY_MODE_FRODO) off the request path
+///
+/// Notes:
+/// - Create one pool per AsymmetricKeyMode in use
+/// - Each key pair is handed out once; private keys left in the pool are zeroized on destruction
+/// - Requests are served directly by the client when the pool is empty
+/// - The client is called concurrently from the workers and must outlive the pool
+/// </summary>
+class KeyPairPool {
+  private:
+    IKeyGenLocalClient& _Client;
+    AsymmetricKeyMode _Mode;
+    size_t _PoolSize;
+    std::deque<AsymmetricKeyPair> _KeyPairs;
+    size_t _NumPending = 0;
+    std::mutex _Mutex;
+    std::condition_variable _Condition;
+    bool _Stop = false;
+    std::vector<std::thread> _Workers;
+
+    void _generateWorker() {
+        std::unique_lock<std::mutex> lock(_Mutex);
+        while (true) {
+            _Condition.wait(lock, [this]() { return _Stop || _KeyPairs.size() + _NumPending < _PoolSize; });
+            if (_Stop) {
+                return;
+            }
+
+            _NumPending++;
+            lock.unlock();
+            AsymmetricKeyPair keyPair;
+            bool failed = false;
+            try {
+                keyPair = _Client.genAsymmetricKeys(_Mode);
+            } catch (const std::exception& e) {
+                logging::logWarning(std::string("KeyPairPool generation failed: ") + e.what());
+                failed = true;
+            }
+            lock.lock();
+            _NumPending--;
+
+            if (failed) {
+                _Condition.wait_for(lock, std::chrono::milliseconds(KEYPAIR_POOL_RETRY_INTERVAL), [this]() { return _Stop; });
+            } else {
+                _KeyPairs.push_back(std::move(keyPair));
+            }
+        }
+    }
+
+  public:
+
+    /// <summary>
+    /// Constructs KeyPairPool and starts the background workers
+    /// </summary>
+    ///
+    /// <param name="client">Initialized local client to generate key pairs with</param>
+    /// <param name="mode">Asymmetric key algorithm</param>
+    /// <param name="poolSize">Number of key pairs to keep pre-generated</param>
+    /// <param name="numWorkers">Number of worker threads. Defaults to the number of hardware threads.</param>
+    KeyPairPool(IKeyGenLocalClient& client, AsymmetricKeyMode mode, size_t poolSize = KEYPAIR_POOL_SIZE_DEFAULT, size_t numWorkers = 0)
+        : _Client(client), _Mode(mode), _PoolSize(poolSize) {
+        if (mode >= AsymmetricKeyMode::NUM_ASYMMETRIC_KEY_MODES) {
+            throw InvalidArgument("Invalid asymmetric key mode");
+        }
+        if (_PoolSize == 0) {
+            throw InvalidArgument("poolSize must be greater than 0");
+        }
+        if (numWorkers == 0) {
+            numWorkers = std::max(1u, std::thread::hardware_concurrency());
+        }
+        numWorkers = std::min(numWorkers, _PoolSize);
+
+        for (size_t i = 0; i < numWorkers; i++) {
+            _Workers.emplace_back(&KeyPairPool::_generateWorker, this);
+        }
+    }
+
+    /// <summary>
+    /// Stops the background workers and zeroizes any unused private keys
+    /// </summary>
+    ~KeyPairPool() {
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _Stop = true;
+        }
+        _Condition.notify_all();
+        for (auto& worker : _Workers) {
+            worker.join();
+        }
+
+        for (auto& keyPair : _KeyPairs) {
+            detail::secureZero(keyPair.privateKey.data(), keyPair.privateKey.size());
+        }
+    }
+
+    KeyPairPool(const KeyPairPool&) = delete;
+    KeyPairPool& operator=(const KeyPairPool&) = delete;
+
+    /// <summary>
+    /// Returns the number of key pairs currently held by the pool
+    /// </summary>
+    size_t available() {
+        std::lock_guard<std::mutex> lock(_Mutex);
+        return _KeyPairs.size();
+    }
+
+    /// <summary>
+    /// Generate asymmetric keys
+    /// </summary>
+    ///
+    /// <returns>Asymmetric key</returns>
+    AsymmetricKeyPair genAsymmetricKeys() {
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            if (!_KeyPairs.empty()) {
+                AsymmetricKeyPair keyPair = std::move(_KeyPairs.front());
+                _KeyPairs.pop_front();
+                _Condition.notify_one();
+                return keyPair;
+            }
+        }
+        return _Client.genAsymmetricKeys(_Mode);
+    }
+
+};
+
+} // namespace
+
+#endif
@@ -7,6 +7,17 @@
 #include <mutex>
 #include <memory>
 #include <iomanip>
+#include <atomic>
+
+/// <summary>
+/// Lowest LogLevel (as an integer) compiled into the QRYPTLIB_LOG_* macros.
+///
+/// Define before including this header to strip lower levels at compile time, e.g.
+/// -DQRYPTLIB_LOG_MIN_LEVEL=2 keeps Info, Warning and Error.
+/// </summary>
+#ifndef QRYPTLIB_LOG_MIN_LEVEL
+#define QRYPTLIB_LOG_MIN_LEVEL 0
+#endif
 
 namespace QryptSecurity 
 {
@@ -139,21 +150,72 @@ namespace logging
     /// </summary>
     void setLogWriter(std::shared_ptr<ILogWriter> logWriter);
 
+    ///<summary>Runtime log level checked by the inline helpers and macros before any work is done</summary>
+    inline std::atomic<int>& logLevelGate()
+    {
+        static std::atomic<int> gate(static_cast<int>(LogLevel::QRYPTLIB_LOG_LEVEL_TRACE));
+        return gate;
+    }
+
+    ///<summary>Returns whether logs at logLevel pass the runtime gate. Lock-free.</summary>
+    /// <param name="logLevel">The LogLevel to check.</param>
+    inline bool isLogLevelEnabled(LogLevel logLevel)
+    {
+        return static_cast<int>(logLevel) >= logLevelGate().load(std::memory_order_relaxed);
+    }
+
+    ///<summary>
+    /// Set the level to log at on both the runtime gate and the active ILogWriter.
+    ///
+    /// Prefer this over calling ILogWriter::setLogLevel directly so that logs below 
+    /// logLevel are skipped before the ILogWriter is looked up or the message is built.
+    ///</summary>
+    /// <param name="logLevel">The LogLevel to set logging at.</param>
+    inline void setLogLevel(LogLevel logLevel)
+    {
+        logLevelGate().store(static_cast<int>(logLevel), std::memory_order_relaxed);
+        getLogWriter()->setLogLevel(logLevel);
+    }
+
     ///<summary>Write a trace log to the active ILogWriter</summary>
-    inline void logTrace(const std::string& message) { getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_TRACE); }
+    inline void logTrace(const std::string& message) { if (isLogLevelEnabled(LogLevel::QRYPTLIB_LOG_LEVEL_TRACE)) getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_TRACE); }
 
     ///<summary>Write a debug log to the active ILogWriter</summary>
-    inline void logDebug(const std::string& message) { getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_DEBUG); }
+    inline void logDebug(const std::string& message) { if (isLogLevelEnabled(LogLevel::QRYPTLIB_LOG_LEVEL_DEBUG)) getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_DEBUG); }
 
     ///<summary>Write an info log to the active ILogWriter</summary>
-    inline void logInfo(const std::string& message) { getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_INFO); }
+    inline void logInfo(const std::string& message) { if (isLogLevelEnabled(LogLevel::QRYPTLIB_LOG_LEVEL_INFO)) getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_INFO); }
 
     ///<summary>Write a warning log to the active ILogWriter</summary>
-    inline void logWarning(const std::string& message) { getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_WARNING); }
+    inline void logWarning(const std::string& message) { if (isLogLevelEnabled(LogLevel::QRYPTLIB_LOG_LEVEL_WARNING)) getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_WARNING); }
 
     ///<summary>Write an error log to the active ILogWriter</summary>
-    inline void logError(const std::string& message) { getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_ERROR); }
+    inline void logError(const std::string& message) { if (isLogLevelEnabled(LogLevel::QRYPTLIB_LOG_LEVEL_ERROR)) getLogWriter()->logMessage(message, LogLevel::QRYPTLIB_LOG_LEVEL_ERROR); }
 
 }
 }
+
+///<summary>
+/// Write a log to the active ILogWriter, building the message from a stream expression 
+/// only when logLevel is enabled at compile time and at runtime.
+///
+/// Example: QRYPTLIB_LOG(QRYPTLIB_LOG_LEVEL_DEBUG, "keySize=" << keySize)
+///</summary>
+#define QRYPTLIB_LOG(logLevel, stream)                                                                        \
+    do {                                                                                                      \
+        if (static_cast<int>(::QryptSecurity::logging::LogLevel::logLevel) >= QRYPTLIB_LOG_MIN_LEVEL &&       \
+            ::QryptSecurity::logging::isLogLevelEnabled(::QryptSecurity::logging::LogLevel::logLevel)) {      \
+            std::ostringstream qryptlibLogStream;                                                             \
+            qryptlibLogStream << stream;                                                                      \
+            ::QryptSecurity::logging::getLogWriter()->logMessage(qryptlibLogStream.str(),                     \
+                                                               ::QryptSecurity::logging::LogLevel::logLevel); \
+        }                                                                                                     \
+    } while (0)
+
+#define QRYPTLIB_LOG_TRACE(stream) QRYPTLIB_LOG(QRYPTLIB_LOG_LEVEL_TRACE, stream)
+#define QRYPTLIB_LOG_DEBUG(stream) QRYPTLIB_LOG(QRYPTLIB_LOG_LEVEL_DEBUG, stream)
+#define QRYPTLIB_LOG_INFO(stream) QRYPTLIB_LOG(QRYPTLIB_LOG_LEVEL_INFO, stream)
+#define QRYPTLIB_LOG_WARNING(stream) QRYPTLIB_LOG(QRYPTLIB_LOG_LEVEL_WARNING, stream)
+#define QRYPTLIB_LOG_ERROR(stream) QRYPTLIB_LOG(QRYPTLIB_LOG_LEVEL_ERROR, stream)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+#ifndef QRYPTSECURITY_MEMORY_H
+#define QRYPTSECURITY_MEMORY_H
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <limits>
+#include <new>
+
+#include "qryptsecurity.h"
+
+namespace QryptSecurity {
+
+namespace detail {
+
+/// <summary>
+/// Assumed size (in bytes) of a CPU cache line
+/// </summary>
+const size_t CACHE_LINE_SIZE = 64;
+
+/// <summary>
+/// Page-aligned buffer for key material
+///
+/// The buffer is mapped on its own pages so that mlock/munlock never affect other heap
+/// objects. It is excluded from core dumps where supported and zeroized before release.
+/// </summary>
+class LockedBuffer {
+  private:
+    uint8_t* _Data = nullptr;
+    size_t _Size = 0;
+    size_t _MappedSize = 0;
+    bool _Locked = false;
+
+    void _release() {
+        if (_Data == nullptr) {
+            return;
+        }
+        secureZero(_Data, _MappedSize);
+        if (_Locked) {
+            munlock(_Data, _MappedSize);
+        }
+        munmap(_Data, _MappedSize);
+        _Data = nullptr;
+        _Size = 0;
+        _MappedSize = 0;
+        _Locked = false;
+    }
+
+  public:
+    LockedBuffer() {}
+
+    ~LockedBuffer() {
+        _release();
+    }
+
+    LockedBuffer(const LockedBuffer&) = delete;
+    LockedBuffer& operator=(const LockedBuffer&) = delete;
+
+    /// <summary>
+    /// Maps a zero-filled buffer of at least size bytes, replacing any previous buffer
+    /// </summary>
+    ///
+    /// <param name="size">Size of the buffer</param>
+    /// <param name="lockMemory">Lock the buffer with mlock so it is never written to swap</param>
+    void allocate(size_t size, bool lockMemory) {
+        _release();
+        if (size == 0) {
+            return;
+        }
+
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t mappedSize = (size + pageSize - 1) / pageSize * pageSize;
+        void* data = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (data == MAP_FAILED) {
+            throw SystemError("Failed to allocate key material memory");
+        }
+        if (lockMemory && mlock(data, mappedSize) != 0) {
+            munmap(data, mappedSize);
+            throw SystemError("Failed to lock key material memory (check RLIMIT_MEMLOCK)");
+        }
+#ifdef MADV_DONTDUMP
+        madvise(data, mappedSize, MADV_DONTDUMP);
+#endif
+
+        _Data = static_cast<uint8_t*>(data);
+        _Size = size;
+        _MappedSize = mappedSize;
+        _Locked = lockMemory;
+    }
+
+    uint8_t* data() {
+        return _Data;
+    }
+
+    size_t size() const {
+        return _Size;
+    }
+};
+
+/// <summary>
+/// Fixed-size array of default-constructed elements that honours alignof(T)
+///
+/// new T[n] only honours over-aligned types from C++17, so the storage is allocated
+/// with posix_memalign instead.
+/// </summary>
+template <typename T>
+class AlignedArray {
+  private:
+    T* _Data = nullptr;
+    size_t _Size = 0;
+
+    void _release() {
+        while (_Size > 0) {
+            _Data[--_Size].~T();
+        }
+        free(_Data);
+        _Data = nullptr;
+    }
+
+  public:
+    AlignedArray() {}
+
+    ~AlignedArray() {
+        _release();
+    }
+
+    AlignedArray(const AlignedArray&) = delete;
+    AlignedArray& operator=(const AlignedArray&) = delete;
+
+    /// <summary>
+    /// Allocates size default-constructed elements, replacing any previous elements
+    /// </summary>
+    ///
+    /// <param name="size">Number of elements</param>
+    void allocate(size_t size) {
+        _release();
+        if (size == 0) {
+            return;
+        }
+        if (size > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+
+        void* data = nullptr;
+        const size_t alignment = alignof(T) < sizeof(void*) ? sizeof(void*) : alignof(T);
+        if (posix_memalign(&data, alignment, size * sizeof(T)) != 0) {
+            throw std::bad_alloc();
+        }
+        _Data = static_cast<T*>(data);
+        for (; _Size < size; _Size++) {
+            new (_Data + _Size) T();
+        }
+    }
+
+    T& operator[](size_t index) {
+        return _Data[index];
+    }
+
+    size_t size() const {
+        return _Size;
+    }
+};
+
+} // namespace detail
+
+} // namespace
+
+#endif
@@ -0,0 +1,288 @@
+#ifndef QRYPTSECURITY_METRICS_H
+#define QRYPTSECURITY_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "qryptsecurity.h"
+
+namespace QryptSecurity {
+
+/// <summary>
+/// Number of buckets in a LatencyHistogram
+/// </summary>
+const size_t NUM_LATENCY_BUCKETS = 32;
+
+/// <summary>
+/// Structure to store a latency histogram snapshot
+/// </summary>
+struct LatencyHistogram {
+
+    /// <summary>
+    /// Number of completed calls, including failed calls
+    /// </summary>
+    uint64_t count;
+
+    /// <summary>
+    /// Number of calls that threw an exception
+    /// </summary>
+    uint64_t errors;
+
+    /// <summary>
+    /// Sum of all call latencies (in nanoseconds)
+    /// </summary>
+    uint64_t totalNanoseconds;
+
+    /// <summary>
+    /// Call counts by latency. Bucket 0 counts calls under 1 microsecond, bucket i counts
+    /// calls from 2^(i-1) up to 2^i microseconds and the last bucket counts all slower calls.
+    /// </summary>
+    uint64_t buckets[NUM_LATENCY_BUCKETS];
+
+};
+
+/// <summary>
+/// Structure for local client metrics
+/// </summary>
+struct LocalClientMetrics {
+
+    /// <summary>
+    /// Latency of genSymmetricKey calls
+    /// </summary>
+    LatencyHistogram genSymmetricKey;
+
+    /// <summary>
+    /// Latency of genAsymmetricKeys calls
+    /// </summary>
+    LatencyHistogram genAsymmetricKeys;
+
+    /// <summary>
+    /// Total symmetric key bytes generated
+    /// </summary>
+    uint64_t symmetricKeyBytes;
+
+};
+
+/// <summary>
+/// Structure for distributed client metrics
+/// </summary>
+struct DistributedClientMetrics {
+
+    /// <summary>
+    /// Latency of genInit calls, including the BLAST server round trips
+    /// </summary>
+    LatencyHistogram genInit;
+
+    /// <summary>
+    /// Latency of genSync calls, including the BLAST server round trips
+    /// </summary>
+    LatencyHistogram genSync;
+
+};
+
+namespace detail {
+
+/// <summary>
+/// Latency histogram that can be updated concurrently without locking
+/// </summary>
+class AtomicLatencyHistogram {
+  private:
+    std::atomic<uint64_t> _Count;
+    std::atomic<uint64_t> _Errors;
+    std::atomic<uint64_t> _TotalNanoseconds;
+    std::atomic<uint64_t> _Buckets[NUM_LATENCY_BUCKETS];
+
+  public:
+    AtomicLatencyHistogram() : _Count(0), _Errors(0), _TotalNanoseconds(0) {
+        for (size_t i = 0; i < NUM_LATENCY_BUCKETS; i++) {
+            _Buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void record(std::chrono::steady_clock::duration latency, bool failed) {
+        const std::chrono::nanoseconds::rep count = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+        const uint64_t nanoseconds = count > 0 ? static_cast<uint64_t>(count) : 0;
+        size_t bucket = 0;
+        for (uint64_t microseconds = nanoseconds / 1000; microseconds > 0 && bucket < NUM_LATENCY_BUCKETS - 1; microseconds >>= 1) {
+            bucket++;
+        }
+        _Count.fetch_add(1, std::memory_order_relaxed);
+        if (failed) {
+            _Errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        _TotalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        _Buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram snapshot() const {
+        LatencyHistogram histogram;
+        histogram.count = _Count.load(std::memory_order_relaxed);
+        histogram.errors = _Errors.load(std::memory_order_relaxed);
+        histogram.totalNanoseconds = _TotalNanoseconds.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < NUM_LATENCY_BUCKETS; i++) {
+            histogram.buckets[i] = _Buckets[i].load(std::memory_order_relaxed);
+        }
+        return histogram;
+    }
+};
+
+/// <summary>
+/// Times a call and records it into an AtomicLatencyHistogram, counting it as failed if it throws
+/// </summary>
+template <typename Function>
+auto timeCall(AtomicLatencyHistogram& histogram, Function function) -> decltype(function()) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    try {
+        auto result = function();
+        histogram.record(std::chrono::steady_clock::now() - start, false);
+        return result;
+    } catch (...) {
+        histogram.record(std::chrono::steady_clock::now() - start, true);
+        throw;
+    }
+}
+
+} // namespace detail
+
+/// <summary>
+/// InstrumentedKeyGenLocalClient
+///
+/// IKeyGenLocalClient that forwards to another client and records call counts and
+/// latency histograms. Metrics are kept in relaxed atomics and can be read at any time
+/// without locking or going through the logger.
+/// </summary>
+class InstrumentedKeyGenLocalClient : public IKeyGenLocalClient {
+  private:
+    std::unique_ptr<IKeyGenLocalClient> _Client;
+    detail::AtomicLatencyHistogram _GenSymmetricKey;
+    detail::AtomicLatencyHistogram _GenAsymmetricKeys;
+    std::atomic<uint64_t> _SymmetricKeyBytes;
+
+  public:
+
+    /// <summary>
+    /// Constructs InstrumentedKeyGenLocalClient
+    /// </summary>
+    ///
+    /// <param name="client">The client to forward calls to</param>
+    InstrumentedKeyGenLocalClient(std::unique_ptr<IKeyGenLocalClient> client)
+        : _Client(std::move(client)), _SymmetricKeyBytes(0) {
+        if (!_Client) {
+            throw InvalidArgument("client must not be null");
+        }
+    }
+
+    /// <summary>
+    /// Returns a snapshot of the metrics recorded so far
+    /// </summary>
+    LocalClientMetrics getMetrics() const {
+        LocalClientMetrics metrics;
+        metrics.genSymmetricKey = _GenSymmetricKey.snapshot();
+        metrics.genAsymmetricKeys = _GenAsymmetricKeys.snapshot();
+        metrics.symmetricKeyBytes = _SymmetricKeyBytes.load(std::memory_order_relaxed);
+        return metrics;
+    }
+
+    void initializeAsync(std::string qryptToken, CacheConfig config) override {
+        _Client->initializeAsync(std::move(qryptToken), std::move(config));
+    }
+
+    void updateDeviceSecret(std::vector<uint8_t> deviceSecret, std::vector<uint8_t> newDeviceSecret) override {
+        _Client->updateDeviceSecret(std::move(deviceSecret), std::move(newDeviceSecret));
+    }
+
+    void wipe() override {
+        _Client->wipe();
+    }
+
+    CacheStatus checkCacheStatus() override {
+        return _Client->checkCacheStatus();
+    }
+
+    AsymmetricKeyPair genAsymmetricKeys(AsymmetricKeyMode mode) override {
+        return detail::timeCall(_GenAsymmetricKeys, [&]() { return _Client->genAsymmetricKeys(mode); });
+    }
+
+    std::vector<uint8_t> genSymmetricKey(SymmetricKeyMode mode) override {
+        std::vector<uint8_t> key = detail::timeCall(_GenSymmetricKey, [&]() { return _Client->genSymmetricKey(mode); });
+        _SymmetricKeyBytes.fetch_add(key.size(), std::memory_order_relaxed);
+        return key;
+    }
+
+    std::vector<uint8_t> genSymmetricKey(SymmetricKeyMode mode, size_t keySize) override {
+        std::vector<uint8_t> key = detail::timeCall(_GenSymmetricKey, [&]() { return _Client->genSymmetricKey(mode, keySize); });
+        _SymmetricKeyBytes.fetch_add(key.size(), std::memory_order_relaxed);
+        return key;
+    }
+
+    using IKeyGenLocalClient::genAsymmetricKeys;
+    using IKeyGenLocalClient::genSymmetricKey;
+
+};
+
+/// <summary>
+/// InstrumentedKeyGenDistributedClient
+///
+/// IKeyGenDistributedClient that forwards to another client and records call counts and
+/// latency histograms. Metrics are kept in relaxed atomics and can be read at any time
+/// without locking or going through the logger.
+/// </summary>
+class InstrumentedKeyGenDistributedClient : public IKeyGenDistributedClient {
+  private:
+    std::unique_ptr<IKeyGenDistributedClient> _Client;
+    detail::AtomicLatencyHistogram _GenInit;
+    detail::AtomicLatencyHistogram _GenSync;
+
+  public:
+
+    /// <summary>
+    /// Constructs InstrumentedKeyGenDistributedClient
+    /// </summary>
+    ///
+    /// <param name="client">The client to forward calls to</param>
+    InstrumentedKeyGenDistributedClient(std::unique_ptr<IKeyGenDistributedClient> client)
+        : _Client(std::move(client)) {
+        if (!_Client) {
+            throw InvalidArgument("client must not be null");
+        }
+    }
+
+    /// <summary>
+    /// Returns a snapshot of the metrics recorded so far
+    /// </summary>
+    DistributedClientMetrics getMetrics() const {
+        DistributedClientMetrics metrics;
+        metrics.genInit = _GenInit.snapshot();
+        metrics.genSync = _GenSync.snapshot();
+        return metrics;
+    }
+
+    void initialize(std::string qryptToken) override {
+        _Client->initialize(std::move(qryptToken));
+    }
+
+    SymmetricKeyData genInit(const SymmetricKeyMode mode) override {
+        return detail::timeCall(_GenInit, [&]() { return _Client->genInit(mode); });
+    }
+
+    SymmetricKeyData genInit(const SymmetricKeyMode mode, const size_t keySize) override {
+        return detail::timeCall(_GenInit, [&]() { return _Client->genInit(mode, keySize); });
+    }
+
+    std::vector<uint8_t> genSync(std::vector<uint8_t> metadata) override {
+        return detail::timeCall(_GenSync, [&]() { return _Client->genSync(std::move(metadata)); });
+    }
+
+    using IKeyGenDistributedClient::genInit;
+    using IKeyGenDistributedClient::genSync;
+
+};
+
+} // namespace
+
+#endif
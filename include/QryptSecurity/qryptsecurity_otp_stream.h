@@ -0,0 +1,82 @@
+#ifndef QRYPTSECURITY_OTP_STREAM_H
+#define QRYPTSECURITY_OTP_STREAM_H
+
+#include <algorithm>
+
+#include "qryptsecurity.h"
+
+namespace QryptSecurity {
+
+/// <summary>
+/// Default maximum number of pad bytes requested from the cache per call
+/// </summary>
+const size_t OTP_STREAM_CHUNK_SIZE_DEFAULT = 1024 * 1024;   // 1 MB
+
+/// <summary>
+/// OtpPadReader
+///
+/// Generates a SYMMETRIC_KEY_MODE_OTP pad of a fixed total size incrementally into
+/// caller-owned buffers, so memory use is bounded by the caller's buffer rather than
+/// the pad size.
+///
+/// Use cases:
+/// - Encrypt files larger than available memory with an OTP pad
+///
+/// Notes:
+/// - Each read requests at most chunkSize bytes from the cache
+/// - Bytes are generated only as they are read; an abandoned reader consumes no more random
+/// - The client must outlive the reader
+/// </summary>
+class OtpPadReader {
+  private:
+    IKeyGenLocalClient& _Client;
+    size_t _Remaining;
+    size_t _ChunkSize;
+
+  public:
+
+    /// <summary>
+    /// Constructs OtpPadReader
+    /// </summary>
+    ///
+    /// <param name="client">Initialized local client to generate the pad with</param>
+    /// <param name="padSize">Total pad size</param>
+    /// <param name="chunkSize">Maximum number of bytes requested from the client per call</param>
+    OtpPadReader(IKeyGenLocalClient& client, size_t padSize, size_t chunkSize = OTP_STREAM_CHUNK_SIZE_DEFAULT)
+        : _Client(client), _Remaining(padSize), _ChunkSize(chunkSize) {
+        if (_ChunkSize == 0) {
+            throw InvalidArgument("chunkSize must be greater than 0");
+        }
+    }
+
+    /// <summary>
+    /// Returns the number of pad bytes not yet read
+    /// </summary>
+    size_t remaining() const {
+        return _Remaining;
+    }
+
+    /// <summary>
+    /// Write the next pad bytes into a caller-owned buffer
+    /// </summary>
+    ///
+    /// <param name="buffer">Buffer to receive the pad bytes</param>
+    /// <param name="size">Size of the buffer</param>
+    /// <returns>Number of pad bytes written, 0 once the whole pad has been read</returns>
+    size_t read(uint8_t* buffer, size_t size) {
+        size = std::min(size, _Remaining);
+        size_t written = 0;
+        while (written < size) {
+            const size_t count = std::min(size - written, _ChunkSize);
+            _Client.genSymmetricKey(SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP, buffer + written, count);
+            written += count;
+            _Remaining -= count;
+        }
+        return written;
+    }
+
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef QRYPTSECURITY_RESERVATION_H
+#define QRYPTSECURITY_RESERVATION_H
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "qryptsecurity.h"
+#include "qryptsecurity_memory.h"
+
+namespace QryptSecurity {
+
+/// <summary>
+/// Default number of random bytes requested from the cache per reservation window
+/// </summary>
+const size_t RESERVATION_WINDOW_SIZE_DEFAULT = 64 * 1024;   // 64 KB
+
+/// <summary>
+/// KeyReservationPool
+///
+/// Hands out symmetric keys to many threads at once from reservation windows of
+/// random taken from an IKeyGenLocalClient.
+///
+/// Use cases:
+/// - Generate symmetric keys from many threads without every call going through the cache
+///
+/// Notes:
+/// - Windows are sharded by calling thread, and each shard has its own lock, so
+///   threads only contend with the few threads that map to the same shard
+/// - A shard only calls into the client when its window runs out
+/// - Bytes are never handed out twice; bytes left in the windows on destruction are
+///   zeroized and discarded
+/// - Windows are page-aligned, excluded from core dumps and, with lockMemory, locked with
+///   mlock; numShards * windowSize bytes must fit within RLIMIT_MEMLOCK
+/// - The client must outlive the pool
+/// </summary>
+class KeyReservationPool {
+  private:
+    // Each shard is aligned to its own cache lines so threads locking different
+    // shards do not contend on the same line
+    struct alignas(detail::CACHE_LINE_SIZE) Shard {
+        std::mutex _Mutex;
+        detail::LockedBuffer _Window;
+        size_t _Cursor = 0;
+    };
+
+    IKeyGenLocalClient& _Client;
+    size_t _WindowSize;
+    size_t _NumShards;
+    detail::AlignedArray<Shard> _Shards;
+
+    Shard& _getShard() {
+        return _Shards[std::hash<std::thread::id>()(std::this_thread::get_id()) % _NumShards];
+    }
+
+  public:
+
+    /// <summary>
+    /// Constructs KeyReservationPool
+    /// </summary>
+    ///
+    /// <param name="client">Initialized local client to take random from</param>
+    /// <param name="windowSize">Number of random bytes requested from the client per window</param>
+    /// <param name="numShards">Number of independent windows. Defaults to the number of hardware threads.</param>
+    /// <param name="lockMemory">Lock the windows with mlock so they are never written to swap</param>
+    KeyReservationPool(IKeyGenLocalClient& client, size_t windowSize = RESERVATION_WINDOW_SIZE_DEFAULT, size_t numShards = 0, bool lockMemory = true)
+        : _Client(client), _WindowSize(windowSize), _NumShards(numShards) {
+        if (_WindowSize == 0) {
+            throw InvalidArgument("windowSize must be greater than 0");
+        }
+        if (_NumShards == 0) {
+            _NumShards = std::max(1u, std::thread::hardware_concurrency());
+        }
+        _Shards.allocate(_NumShards);
+        for (size_t i = 0; i < _NumShards; i++) {
+            _Shards[i]._Window.allocate(_WindowSize, lockMemory);
+            _Shards[i]._Cursor = _WindowSize;
+        }
+    }
+
+    KeyReservationPool(const KeyReservationPool&) = delete;
+    KeyReservationPool& operator=(const KeyReservationPool&) = delete;
+
+    /// <summary>
+    /// Write unused random bytes into a caller-owned buffer
+    ///
+    /// Requests of at least windowSize bytes bypass the windows.
+    /// </summary>
+    ///
+    /// <param name="buffer">Buffer to receive the random</param>
+    /// <param name="size">Number of bytes to write</param>
+    void reserve(uint8_t* buffer, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        if (buffer == nullptr) {
+            throw InvalidArgument("buffer must not be null");
+        }
+        if (size >= _WindowSize) {
+            _Client.genSymmetricKey(SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP, buffer, size);
+            return;
+        }
+
+        Shard& shard = _getShard();
+        std::lock_guard<std::mutex> lock(shard._Mutex);
+        while (size > 0) {
+            if (shard._Cursor == _WindowSize) {
+                _Client.genSymmetricKey(SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP, shard._Window.data(), _WindowSize);
+                shard._Cursor = 0;
+            }
+            const size_t count = std::min(size, _WindowSize - shard._Cursor);
+            uint8_t* begin = shard._Window.data() + shard._Cursor;
+            std::copy(begin, begin + count, buffer);
+            detail::secureZero(begin, count);
+            shard._Cursor += count;
+            buffer += count;
+            size -= count;
+        }
+    }
+
+    /// <summary>
+    /// Generate symmetric keys
+    /// </summary>
+    ///
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <returns>Symmetric key</returns>
+    std::vector<uint8_t> genSymmetricKey(SymmetricKeyMode mode) {
+        return genSymmetricKey(mode, 0);
+    }
+
+    /// <summary>
+    /// Generate symmetric keys
+    ///
+    /// The input argument keySize is ignored for SYMMETRIC_KEY_MODE_AES_256 mode.
+    /// </summary>
+    ///
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="keySize">Symmetric key size when using OTP mode</param>
+    /// <returns>Symmetric key</returns>
+    std::vector<uint8_t> genSymmetricKey(SymmetricKeyMode mode, size_t keySize) {
+        std::vector<uint8_t> key(detail::symmetricKeySize(mode, keySize));
+        reserve(key.data(), key.size());
+        return key;
+    }
+
+};
+
+} // namespace
+
+#endif
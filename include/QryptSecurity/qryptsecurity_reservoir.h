@@ -0,0 +1,352 @@
+#ifndef QRYPTSECURITY_RESERVOIR_H
+#define QRYPTSECURITY_RESERVOIR_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "qryptsecurity.h"
+#include "qryptsecurity_logging.h"
+#include "qryptsecurity_memory.h"
+
+namespace QryptSecurity {
+
+/// <summary>
+/// Structure to store key reservoir configurations
+/// </summary>
+struct ReservoirConfig {
+
+    /// <summary>
+    /// Size (in bytes) of the blocks random is handed out in
+    /// </summary>
+    size_t blockSize = AES_256_KEY_SIZE;
+
+    /// <summary>
+    /// Maximum number of random bytes held in memory (rounded up to a power of two blocks)
+    /// </summary>
+    size_t capacity = 1024 * 1024;
+
+    /// <summary>
+    /// Number of random bytes below which the reservoir is refilled (must be greater than 0)
+    /// </summary>
+    size_t lowWaterMark = 256 * 1024;
+
+    /// <summary>
+    /// Raise the low-water mark at runtime so a refill started at the mark completes
+    /// before the reservoir runs dry at the observed consumption rate
+    /// </summary>
+    bool adaptiveLowWaterMark = true;
+
+    /// <summary>
+    /// Time (in milliseconds) between refill attempts when idle or after a failed refill
+    /// </summary>
+    size_t refillInterval = 1000;
+
+    /// <summary>
+    /// Lock the reservoir memory with mlock so it is never written to swap
+    /// </summary>
+    bool lockMemory = true;
+
+};
+
+/// <summary>
+/// KeyReservoir
+///
+/// In-memory reservoir of random taken from an IKeyGenLocalClient, kept filled by a
+/// background thread and handed out through a lock-free ring buffer.
+///
+/// Use cases:
+/// - Generate symmetric keys on latency-sensitive paths without calling into the cache
+///
+/// Notes:
+/// - Random is handed out in whole blocks; the unused tail of a block is zeroized and discarded
+/// - Blocks are zeroized as soon as they are handed out and on destruction
+/// - Requests are served directly by the client when the reservoir is empty
+/// - With adaptiveLowWaterMark the refill starts earlier as the consumption rate rises
+/// - The client must outlive the reservoir
+/// </summary>
+class KeyReservoir {
+  private:
+    IKeyGenLocalClient& _Client;
+    ReservoirConfig _Config;
+    size_t _NumBlocks;
+    size_t _LowWaterBlocks;
+    size_t _DataSize;
+    detail::LockedBuffer _Data;
+    std::unique_ptr<std::atomic<size_t>[]> _Sequences;
+
+    // Producer and consumer cursors are kept on separate cache lines
+    std::atomic<size_t> _EnqueuePos;
+    char _Padding[64];
+    std::atomic<size_t> _DequeuePos;
+    std::atomic<bool> _RefillRequested;
+    std::atomic<size_t> _RefillTriggerBlocks;
+
+    std::mutex _Mutex;
+    std::condition_variable _Condition;
+    bool _Stop = false;
+    std::thread _Thread;
+
+    uint8_t* _block(size_t pos) {
+        return _Data.data() + (pos & (_NumBlocks - 1)) * _Config.blockSize;
+    }
+
+    bool _pop(uint8_t* buffer, size_t size) {
+        size_t pos = _DequeuePos.load(std::memory_order_relaxed);
+        while (true) {
+            std::atomic<size_t>& sequence = _Sequences[pos & (_NumBlocks - 1)];
+            const size_t seq = sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t dif = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (dif == 0) {
+                if (_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    uint8_t* block = _block(pos);
+                    std::copy(block, block + size, buffer);
+                    detail::secureZero(block, _Config.blockSize);
+                    sequence.store(pos + _NumBlocks, std::memory_order_release);
+                    return true;
+                }
+            } else if (dif < 0) {
+                return false;
+            } else {
+                pos = _DequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool _push(const uint8_t* block) {
+        // Only the refill thread enqueues
+        const size_t pos = _EnqueuePos.load(std::memory_order_relaxed);
+        std::atomic<size_t>& sequence = _Sequences[pos & (_NumBlocks - 1)];
+        if (sequence.load(std::memory_order_acquire) != pos) {
+            return false;
+        }
+        std::copy(block, block + _Config.blockSize, _block(pos));
+        sequence.store(pos + 1, std::memory_order_release);
+        _EnqueuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t _availableBlocks() const {
+        const size_t enqueuePos = _EnqueuePos.load(std::memory_order_relaxed);
+        const size_t dequeuePos = _DequeuePos.load(std::memory_order_relaxed);
+        return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+    }
+
+    bool _belowRefillTrigger() const {
+        return _availableBlocks() < _RefillTriggerBlocks.load(std::memory_order_relaxed);
+    }
+
+    void _requestRefill() {
+        if (_belowRefillTrigger() && !_RefillRequested.exchange(true)) {
+            // Taking the mutex orders the notification after the worker's predicate check
+            { std::lock_guard<std::mutex> lock(_Mutex); }
+            _Condition.notify_one();
+        }
+    }
+
+    bool _refill() {
+        const size_t numBlocks = _NumBlocks - _availableBlocks();
+        if (numBlocks == 0) {
+            return true;
+        }
+
+        std::vector<uint8_t> random;
+        try {
+            random = _Client.genSymmetricKey(SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP, numBlocks * _Config.blockSize);
+        } catch (const std::exception& e) {
+            logging::logWarning(std::string("KeyReservoir refill failed: ") + e.what());
+            return false;
+        }
+
+        for (size_t i = 0; i + _Config.blockSize <= random.size(); i += _Config.blockSize) {
+            if (!_push(random.data() + i)) {
+                break;
+            }
+        }
+        detail::secureZero(random.data(), random.size());
+        return true;
+    }
+
+    void _updateRefillTrigger(double consumptionRate, double refillSeconds) {
+        // Keep enough blocks to cover twice the time a refill takes at the current rate
+        const double predictedBlocks = 2.0 * consumptionRate * refillSeconds;
+        const size_t maxTriggerBlocks = std::max(_LowWaterBlocks, _NumBlocks / 2);
+        size_t triggerBlocks = _LowWaterBlocks;
+        if (predictedBlocks >= static_cast<double>(maxTriggerBlocks)) {
+            triggerBlocks = maxTriggerBlocks;
+        } else if (predictedBlocks > static_cast<double>(_LowWaterBlocks)) {
+            triggerBlocks = static_cast<size_t>(predictedBlocks) + 1;
+        }
+        _RefillTriggerBlocks.store(triggerBlocks, std::memory_order_relaxed);
+    }
+
+    void _refillWorker() {
+        typedef std::chrono::steady_clock Clock;
+        const std::chrono::milliseconds interval(_Config.refillInterval);
+        bool failed = false;
+        size_t lastDequeuePos = 0;
+        Clock::time_point lastTime = Clock::now();
+        double consumptionRate = 0;   // Blocks per second
+        double refillSeconds = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(_Mutex);
+                _Condition.wait_for(lock, interval, [this, failed]() {
+                    return _Stop || (!failed && _belowRefillTrigger());
+                });
+                if (_Stop) {
+                    return;
+                }
+            }
+
+            // Clear on every wake so the next low-water crossing notifies again, even if
+            // the recomputed trigger means no refill runs this time
+            _RefillRequested.store(false);
+
+            if (_Config.adaptiveLowWaterMark) {
+                const Clock::time_point now = Clock::now();
+                const double elapsed = std::chrono::duration<double>(now - lastTime).count();
+                const size_t dequeuePos = _DequeuePos.load(std::memory_order_relaxed);
+                if (elapsed > 0) {
+                    const double rate = static_cast<double>(dequeuePos - lastDequeuePos) / elapsed;
+                    consumptionRate = consumptionRate == 0 ? rate : 0.5 * consumptionRate + 0.5 * rate;
+                }
+                lastDequeuePos = dequeuePos;
+                lastTime = now;
+                _updateRefillTrigger(consumptionRate, refillSeconds);
+            }
+
+            failed = false;
+            if (_belowRefillTrigger()) {
+                const Clock::time_point start = Clock::now();
+                failed = !_refill();
+                if (!failed) {
+                    refillSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+                }
+            }
+        }
+    }
+
+  public:
+
+    /// <summary>
+    /// Constructs KeyReservoir and starts the background refill thread
+    /// </summary>
+    ///
+    /// <param name="client">Initialized local client to take random from</param>
+    /// <param name="config">Reservoir configuration</param>
+    KeyReservoir(IKeyGenLocalClient& client, ReservoirConfig config = ReservoirConfig())
+        : _Client(client), _Config(config), _EnqueuePos(0), _DequeuePos(0), _RefillRequested(false), _RefillTriggerBlocks(0) {
+        if (_Config.blockSize == 0 || _Config.capacity < _Config.blockSize) {
+            throw InvalidArgument("capacity must be at least one non-empty block");
+        }
+        if (_Config.lowWaterMark == 0 || _Config.lowWaterMark > _Config.capacity) {
+            throw InvalidArgument("lowWaterMark must be greater than 0 and not exceed capacity");
+        }
+
+        _NumBlocks = 1;
+        while (_NumBlocks * _Config.blockSize < _Config.capacity) {
+            _NumBlocks <<= 1;
+        }
+        _LowWaterBlocks = (_Config.lowWaterMark + _Config.blockSize - 1) / _Config.blockSize;
+        _DataSize = _NumBlocks * _Config.blockSize;
+        _RefillTriggerBlocks.store(_LowWaterBlocks, std::memory_order_relaxed);
+
+        _Data.allocate(_DataSize, _Config.lockMemory);
+        _Sequences.reset(new std::atomic<size_t>[_NumBlocks]);
+        for (size_t i = 0; i < _NumBlocks; i++) {
+            _Sequences[i].store(i, std::memory_order_relaxed);
+        }
+
+        _Thread = std::thread(&KeyReservoir::_refillWorker, this);
+        _requestRefill();
+    }
+
+    /// <summary>
+    /// Stops the background refill thread and zeroizes any unused random
+    /// </summary>
+    ~KeyReservoir() {
+        {
+            std::lock_guard<std::mutex> lock(_Mutex);
+            _Stop = true;
+        }
+        _Condition.notify_one();
+        _Thread.join();
+    }
+
+    KeyReservoir(const KeyReservoir&) = delete;
+    KeyReservoir& operator=(const KeyReservoir&) = delete;
+
+    /// <summary>
+    /// Returns the number of random bytes currently held by the reservoir
+    /// </summary>
+    size_t available() const {
+        return _availableBlocks() * _Config.blockSize;
+    }
+
+    /// <summary>
+    /// Write unused random bytes into a caller-owned buffer
+    /// </summary>
+    ///
+    /// <param name="buffer">Buffer to receive the random</param>
+    /// <param name="size">Number of bytes to write</param>
+    void reserve(uint8_t* buffer, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        if (buffer == nullptr) {
+            throw InvalidArgument("buffer must not be null");
+        }
+
+        while (size > 0) {
+            const size_t count = std::min(size, _Config.blockSize);
+            if (!_pop(buffer, count)) {
+                break;
+            }
+            buffer += count;
+            size -= count;
+        }
+        _requestRefill();
+
+        if (size > 0) {
+            _Client.genSymmetricKey(SymmetricKeyMode::SYMMETRIC_KEY_MODE_OTP, buffer, size);
+        }
+    }
+
+    /// <summary>
+    /// Generate symmetric keys
+    /// </summary>
+    ///
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <returns>Symmetric key</returns>
+    std::vector<uint8_t> genSymmetricKey(SymmetricKeyMode mode) {
+        return genSymmetricKey(mode, 0);
+    }
+
+    /// <summary>
+    /// Generate symmetric keys
+    ///
+    /// The input argument keySize is ignored for SYMMETRIC_KEY_MODE_AES_256 mode.
+    /// </summary>
+    ///
+    /// <param name="mode">Symmetric key algorithm</param>
+    /// <param name="keySize">Symmetric key size when using OTP mode</param>
+    /// <returns>Symmetric key</returns>
+    std::vector<uint8_t> genSymmetricKey(SymmetricKeyMode mode, size_t keySize) {
+        std::vector<uint8_t> key(detail::symmetricKeySize(mode, keySize));
+        reserve(key.data(), key.size());
+        return key;
+    }
+
+};
+
+} // namespace
+
+#endif